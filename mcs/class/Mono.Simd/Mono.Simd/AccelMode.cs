@@ -45,5 +45,7 @@ namespace Mono.Simd
 		SSE41	= 1 << 4,
 		SSE42	= 1 << 5,
 		SSE4A	= 1 << 6,
+		AVX	= 1 << 7,
+		AVX2	= 1 << 8,
 	}
 }
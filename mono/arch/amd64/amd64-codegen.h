@@ -1408,6 +1408,91 @@ typedef union {
 
 #define amd64_sse_prefetch_reg_membase(inst, arg, basereg, disp) emit_sse_reg_membase_op2((inst), (arg), (basereg), (disp), 0x0f, 0x18)
 
+/* VEX encoded (AVX) defines */
+
+/* Values of the VEX.pp field, standing in for the legacy SSE prefixes */
+#define AMD64_VEX_PP_NONE 0
+#define AMD64_VEX_PP_66   1
+#define AMD64_VEX_PP_F3   2
+#define AMD64_VEX_PP_F2   3
+
+/* Values of the VEX.mmmmm field, standing in for the legacy escape bytes */
+#define AMD64_VEX_MAP_0F   1
+#define AMD64_VEX_MAP_0F38 2
+#define AMD64_VEX_MAP_0F3A 3
+
+/*
+ * Emit a VEX prefix. REG is the register in ModRM.reg, VREG the extra
+ * (non destructive) source operand, INDEX/RM the registers in SIB.index and
+ * ModRM.rm. L selects 128 (0) or 256 (1) bit operation. The two byte form is
+ * used when the instruction doesn't need VEX.W, VEX.X, VEX.B or a map other
+ * than 0F.
+ */
+#define amd64_emit_vex(inst,l,pp,map,w,reg,vreg,index,rm) do { \
+	if (!(w) && ((index) < 8) && ((rm) < 8) && ((map) == AMD64_VEX_MAP_0F)) { \
+		*(inst)++ = (unsigned char)0xc5; \
+		*(inst)++ = (unsigned char)((((reg) > 7) ? 0 : 0x80) | ((~(vreg) & 0xf) << 3) | (((l) & 1) << 2) | ((pp) & 3)); \
+	} else { \
+		*(inst)++ = (unsigned char)0xc4; \
+		*(inst)++ = (unsigned char)((((reg) > 7) ? 0 : 0x80) | (((index) > 7) ? 0 : 0x40) | (((rm) > 7) ? 0 : 0x20) | ((map) & 0x1f)); \
+		*(inst)++ = (unsigned char)(((w) ? 0x80 : 0) | ((~(vreg) & 0xf) << 3) | (((l) & 1) << 2) | ((pp) & 3)); \
+	} \
+} while (0)
+
+#define emit_vex_reg_reg_reg_size(inst,dreg,sreg1,sreg2,pp,map,op,l) do { \
+    amd64_codegen_pre(inst); \
+    amd64_emit_vex ((inst), (l), (pp), (map), 0, (dreg), (sreg1), 0, (sreg2)); \
+    *(inst)++ = (unsigned char)(op); \
+    x86_reg_emit ((inst), (dreg), (sreg2)); \
+    amd64_codegen_post(inst); \
+} while (0)
+
+/* dreg = sreg1 OP sreg2, 128 bits */
+#define emit_vex_reg_reg_reg(inst,dreg,sreg1,sreg2,pp,map,op) emit_vex_reg_reg_reg_size ((inst), (dreg), (sreg1), (sreg2), (pp), (map), (op), 0)
+
+/* dreg = sreg1 OP sreg2, 256 bits (ymm registers) */
+#define emit_vex_reg_reg_reg_256(inst,dreg,sreg1,sreg2,pp,map,op) emit_vex_reg_reg_reg_size ((inst), (dreg), (sreg1), (sreg2), (pp), (map), (op), 1)
+
+/* Zero the upper half of all ymm registers, to avoid AVX <-> SSE transition penalties */
+#define amd64_vzeroupper(inst) do { amd64_codegen_pre(inst); *(inst)++ = (unsigned char)0xc5; *(inst)++ = (unsigned char)0xf8; *(inst)++ = (unsigned char)0x77; amd64_codegen_post(inst); } while (0)
+
+#define amd64_vex_addsd_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_F2, AMD64_VEX_MAP_0F, 0x58)
+#define amd64_vex_subsd_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_F2, AMD64_VEX_MAP_0F, 0x5c)
+#define amd64_vex_mulsd_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_F2, AMD64_VEX_MAP_0F, 0x59)
+#define amd64_vex_divsd_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_F2, AMD64_VEX_MAP_0F, 0x5e)
+
+#define amd64_vex_addss_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_F3, AMD64_VEX_MAP_0F, 0x58)
+#define amd64_vex_subss_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_F3, AMD64_VEX_MAP_0F, 0x5c)
+#define amd64_vex_mulss_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_F3, AMD64_VEX_MAP_0F, 0x59)
+#define amd64_vex_divss_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_F3, AMD64_VEX_MAP_0F, 0x5e)
+
+#define amd64_vex_addps_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_NONE, AMD64_VEX_MAP_0F, 0x58)
+#define amd64_vex_subps_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_NONE, AMD64_VEX_MAP_0F, 0x5c)
+#define amd64_vex_mulps_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_NONE, AMD64_VEX_MAP_0F, 0x59)
+#define amd64_vex_divps_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_NONE, AMD64_VEX_MAP_0F, 0x5e)
+#define amd64_vex_andps_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_NONE, AMD64_VEX_MAP_0F, 0x54)
+#define amd64_vex_orps_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_NONE, AMD64_VEX_MAP_0F, 0x56)
+#define amd64_vex_xorps_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_NONE, AMD64_VEX_MAP_0F, 0x57)
+
+#define amd64_vex_addpd_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F, 0x58)
+#define amd64_vex_subpd_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F, 0x5c)
+#define amd64_vex_mulpd_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F, 0x59)
+#define amd64_vex_divpd_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F, 0x5e)
+
+#define amd64_vex_paddd_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F, 0xfe)
+#define amd64_vex_psubd_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F, 0xfa)
+#define amd64_vex_pand_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F, 0xdb)
+#define amd64_vex_por_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F, 0xeb)
+#define amd64_vex_pxor_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F, 0xef)
+#define amd64_vex_pmulld_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F38, 0x40)
+
+/* 256 bit forms. paddd/psubd/pmulld on ymm registers require AVX2 */
+#define amd64_vex_addps_256_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg_256 ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_NONE, AMD64_VEX_MAP_0F, 0x58)
+#define amd64_vex_mulps_256_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg_256 ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_NONE, AMD64_VEX_MAP_0F, 0x59)
+#define amd64_vex_addpd_256_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg_256 ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F, 0x58)
+#define amd64_vex_mulpd_256_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg_256 ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F, 0x59)
+#define amd64_vex_paddd_256_reg_reg_reg(inst,dreg,sreg1,sreg2) emit_vex_reg_reg_reg_256 ((inst), (dreg), (sreg1), (sreg2), AMD64_VEX_PP_66, AMD64_VEX_MAP_0F, 0xfe)
+
 /* Generated from x86-codegen.h */
 
 #define amd64_breakpoint_size(inst,size) do { x86_breakpoint(inst); } while (0)
@@ -806,5 +806,23 @@ class Tests
 		short b = (short)a;
 		return b == 127 ? 0 : 1;
 	}
+
+	/* The operands stay live after the operation, so sreg1 != dreg with the 3 operand forms */
+	public static int test_0_float_ops_live_operands () {
+		double a = 5.0, b = 2.0;
+		float fa = 5.0f, fb = 2.0f;
+
+		double add = a + b, sub = a - b, mul = a * b, div = a / b;
+		if (add != 7.0 || sub != 3.0 || mul != 10.0 || div != 2.5)
+			return 1;
+		if (a != 5.0 || b != 2.0)
+			return 2;
+		float fadd = fa + fb, fsub = fa - fb, fmul = fa * fb, fdiv = fa / fb;
+		if (fadd != 7.0f || fsub != 3.0f || fmul != 10.0f || fdiv != 2.5f)
+			return 3;
+		if (fa != 5.0f || fb != 2.0f)
+			return 4;
+		return 0;
+	}
 }
 
@@ -0,0 +1,363 @@
+/*
+ * devirt-profile.c: Receiver type profile for guarded devirtualization
+ *
+ * The vtable/IMT trampolines record which concrete classes are seen as the
+ * receivers of each virtual/interface method. The profile is saved to the
+ * file named by the MONO_DEVIRT_PROFILE env var on shutdown, and loaded from
+ * it on startup, so a later run can compile monomorphic/bimorphic call sites
+ * into vtable guarded direct (usually inlined) calls.
+ *
+ * The profile is keyed by the method which introduces the vtable slot, or by
+ * the interface method for interface calls, not by call site, since the
+ * trampolines only run once per vtable slot.
+ *
+ * Copyright 2015 Xamarin, Inc (http://www.xamarin.com)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mini.h"
+#include <mono/metadata/assembly.h>
+#include <mono/metadata/debug-helpers.h>
+#include <mono/utils/mono-mutex.h>
+
+#define PROFILE_HEADER "# mono devirt profile 1"
+
+typedef struct {
+	char *aname;
+	char *name_space;
+	char *name;
+	int count;
+} DevirtProfileClass;
+
+struct _MonoDevirtProfileEntry {
+	char *method_name;
+	/* List of DevirtProfileClass */
+	GSList *classes;
+	/* Incremented by the code emitted for guarded call sites if --stats is enabled */
+	gint32 guard_hits;
+	gint32 guard_misses;
+};
+
+static gboolean devirt_profile_inited;
+static char *devirt_profile_file;
+/* Maps method full names to MonoDevirtProfileEntry structures */
+static GHashTable *devirt_profile_hash;
+static mono_mutex_t devirt_profile_mutex;
+
+#define devirt_profile_lock() mono_mutex_lock (&devirt_profile_mutex)
+#define devirt_profile_unlock() mono_mutex_unlock (&devirt_profile_mutex)
+
+static MonoDevirtProfileEntry*
+get_entry (const char *method_name, gboolean create)
+{
+	MonoDevirtProfileEntry *entry;
+
+	entry = g_hash_table_lookup (devirt_profile_hash, method_name);
+	if (!entry && create) {
+		entry = g_new0 (MonoDevirtProfileEntry, 1);
+		entry->method_name = g_strdup (method_name);
+		g_hash_table_insert (devirt_profile_hash, entry->method_name, entry);
+	}
+	return entry;
+}
+
+static void
+add_class (MonoDevirtProfileEntry *entry, const char *aname, const char *name_space, const char *name, int count)
+{
+	DevirtProfileClass *pclass;
+	GSList *l;
+
+	for (l = entry->classes; l; l = l->next) {
+		pclass = l->data;
+		if (!strcmp (pclass->aname, aname) && !strcmp (pclass->name_space, name_space) && !strcmp (pclass->name, name)) {
+			pclass->count += count;
+			return;
+		}
+	}
+
+	pclass = g_new0 (DevirtProfileClass, 1);
+	pclass->aname = g_strdup (aname);
+	pclass->name_space = g_strdup (name_space);
+	pclass->name = g_strdup (name);
+	pclass->count = count;
+	entry->classes = g_slist_prepend (entry->classes, pclass);
+}
+
+static void
+load_profile (const char *filename)
+{
+	FILE *f;
+	char line [4096];
+
+	f = fopen (filename, "r");
+	if (!f)
+		return;
+
+	if (!fgets (line, sizeof (line), f) || strncmp (line, PROFILE_HEADER, strlen (PROFILE_HEADER))) {
+		g_warning ("Ignoring devirt profile '%s' with an unknown format.", filename);
+		fclose (f);
+		return;
+	}
+
+	/* <method name>\t<count>\t<assembly name>\t<namespace>\t<class name> */
+	while (fgets (line, sizeof (line), f)) {
+		char **parts;
+
+		g_strchomp (line);
+		parts = g_strsplit (line, "\t", 5);
+		if (g_strv_length (parts) == 5)
+			add_class (get_entry (parts [0], TRUE), parts [2], parts [3], parts [4], atoi (parts [1]));
+		g_strfreev (parts);
+	}
+
+	fclose (f);
+}
+
+static void
+save_entry (gpointer key, gpointer value, gpointer user_data)
+{
+	MonoDevirtProfileEntry *entry = value;
+	FILE *f = user_data;
+	GSList *l;
+
+	for (l = entry->classes; l; l = l->next) {
+		DevirtProfileClass *pclass = l->data;
+
+		fprintf (f, "%s\t%d\t%s\t%s\t%s\n", entry->method_name, pclass->count, pclass->aname, pclass->name_space, pclass->name);
+	}
+}
+
+static void
+print_entry_stats (gpointer key, gpointer value, gpointer user_data)
+{
+	MonoDevirtProfileEntry *entry = value;
+	gint32 *totals = user_data;
+	gint32 total = entry->guard_hits + entry->guard_misses;
+
+	if (!total)
+		return;
+	g_print ("  %-60s hits: %8d misses: %8d (%.1f%%)\n", entry->method_name, entry->guard_hits, entry->guard_misses, (entry->guard_hits * 100.0) / total);
+	totals [0] += entry->guard_hits;
+	totals [1] += entry->guard_misses;
+}
+
+/*
+ * mono_devirt_profile_init:
+ *
+ *   Enable receiver type profiling if the MONO_DEVIRT_PROFILE env var is set,
+ * loading the profile saved by a previous run if it exists.
+ */
+void
+mono_devirt_profile_init (void)
+{
+	const char *filename = g_getenv ("MONO_DEVIRT_PROFILE");
+
+	if (!filename || !filename [0])
+		return;
+
+	mono_mutex_init (&devirt_profile_mutex);
+	devirt_profile_hash = g_hash_table_new (g_str_hash, g_str_equal);
+	devirt_profile_file = g_strdup (filename);
+
+	load_profile (filename);
+
+	devirt_profile_inited = TRUE;
+}
+
+gboolean
+mono_devirt_profile_enabled (void)
+{
+	return devirt_profile_inited;
+}
+
+/*
+ * get_slot_root_method:
+ *
+ *   Return the method which introduces vtable slot SLOT in the hierarchy of KLASS.
+ * Overrides share the slot, so this gives a key which is the same for the method
+ * referenced by a call site and for the implementation called at runtime.
+ */
+static MonoMethod*
+get_slot_root_method (MonoClass *klass, int slot)
+{
+	while (klass->parent) {
+		mono_class_setup_vtable (klass->parent);
+		if (klass->parent->exception_type || slot >= klass->parent->vtable_size)
+			break;
+		klass = klass->parent;
+	}
+
+	return mono_class_get_vtable_entry (klass, slot);
+}
+
+static char*
+get_key (MonoMethod *method)
+{
+	if (!(method->klass->flags & TYPE_ATTRIBUTE_INTERFACE)) {
+		int slot = mono_method_get_vtable_slot (method);
+
+		if (slot == -1)
+			return NULL;
+		method = get_slot_root_method (method->klass, slot);
+		if (!method)
+			return NULL;
+	}
+
+	return mono_method_full_name (method, TRUE);
+}
+
+/*
+ * mono_devirt_profile_record:
+ *
+ *   Record that VT->klass was the receiver of a call to the method occupying vtable
+ * slot SLOT, or of a call to the interface method IMT_METHOD if SLOT is negative.
+ * Called by the vtable trampoline.
+ */
+void
+mono_devirt_profile_record (MonoVTable *vt, int slot, MonoMethod *imt_method)
+{
+	MonoClass *klass = vt->klass;
+	MonoMethod *method;
+	char *key;
+
+	/* Only classes which can be found by name in a later run are recorded */
+	if (klass->generic_class || klass->nested_in || klass->rank || klass->valuetype)
+		return;
+
+	if (slot >= 0) {
+		method = get_slot_root_method (klass, slot);
+	} else {
+		method = imt_method;
+		if (!method || method->is_inflated || method->klass->generic_class)
+			return;
+	}
+	if (!method)
+		return;
+
+	key = mono_method_full_name (method, TRUE);
+
+	devirt_profile_lock ();
+	add_class (get_entry (key, TRUE), klass->image->assembly_name, klass->name_space, klass->name, 1);
+	devirt_profile_unlock ();
+
+	g_free (key);
+}
+
+/*
+ * mono_devirt_profile_get_classes:
+ *
+ *   Return the receiver classes recorded for calls to the virtual or interface method
+ * METHOD, ordered by decreasing frequency, in CLASSES. Returns the number of classes
+ * stored, or 0 if there is no profile data or more than MAX classes were recorded,
+ * i.e. the call is megamorphic. ENTRY is set to the profile entry, which holds the
+ * guard hit counters.
+ */
+int
+mono_devirt_profile_get_classes (MonoMethod *method, MonoClass **classes, int max, MonoDevirtProfileEntry **out_entry)
+{
+	MonoDevirtProfileEntry *entry;
+	DevirtProfileClass *pclasses [16];
+	GSList *l;
+	char *key;
+	int i, j, n, res;
+
+	g_assert (max <= 16);
+
+	key = get_key (method);
+	if (!key)
+		return 0;
+
+	devirt_profile_lock ();
+	entry = get_entry (key, FALSE);
+	n = 0;
+	if (entry) {
+		for (l = entry->classes; l; l = l->next) {
+			if (n == max) {
+				n = 0;
+				break;
+			}
+			pclasses [n ++] = l->data;
+		}
+	}
+	/* Sort by decreasing frequency, the guard for the most frequent class comes first */
+	for (i = 0; i < n; ++i) {
+		for (j = i + 1; j < n; ++j) {
+			if (pclasses [j]->count > pclasses [i]->count) {
+				DevirtProfileClass *tmp = pclasses [i];
+				pclasses [i] = pclasses [j];
+				pclasses [j] = tmp;
+			}
+		}
+	}
+	res = 0;
+	for (i = 0; i < n; ++i) {
+		MonoAssembly *assembly;
+		MonoAssemblyName aname;
+		MonoClass *klass = NULL;
+
+		/* Don't load assemblies from the JIT, if the assembly is not loaded, there can be no instances of the class */
+		if (mono_assembly_name_parse (pclasses [i]->aname, &aname)) {
+			assembly = mono_assembly_loaded (&aname);
+			if (assembly)
+				klass = mono_class_from_name (assembly->image, pclasses [i]->name_space, pclasses [i]->name);
+			mono_assembly_name_free (&aname);
+		}
+		if (klass)
+			classes [res ++] = klass;
+	}
+	devirt_profile_unlock ();
+
+	g_free (key);
+
+	if (out_entry)
+		*out_entry = entry;
+	return res;
+}
+
+/*
+ * mono_devirt_profile_cleanup:
+ *
+ *   Save the profile collected by this run and print guard hit rates if --stats is enabled.
+ */
+void
+mono_devirt_profile_cleanup (void)
+{
+	FILE *f;
+
+	if (!devirt_profile_inited)
+		return;
+
+	if (mono_jit_stats.enabled) {
+		gint32 totals [2] = { 0, 0 };
+
+		g_print ("\nGuarded devirtualization:\n");
+		g_hash_table_foreach (devirt_profile_hash, print_entry_stats, totals);
+		g_print ("Guard hits:             %d\n", totals [0]);
+		g_print ("Guard misses:           %d\n", totals [1]);
+	}
+
+	f = fopen (devirt_profile_file, "w");
+	if (f) {
+		fprintf (f, "%s\n", PROFILE_HEADER);
+		g_hash_table_foreach (devirt_profile_hash, save_entry, f);
+		fclose (f);
+	} else {
+		g_warning ("Unable to save devirt profile to '%s'.", devirt_profile_file);
+	}
+
+	devirt_profile_inited = FALSE;
+}
+
+gint32*
+mono_devirt_profile_entry_get_hits (MonoDevirtProfileEntry *entry)
+{
+	return &entry->guard_hits;
+}
+
+gint32*
+mono_devirt_profile_entry_get_misses (MonoDevirtProfileEntry *entry)
+{
+	return &entry->guard_misses;
+}
@@ -6965,6 +6965,167 @@ inline_method (MonoCompile *cfg, MonoMethod *cmethod, MonoMethodSignature *fsig,
 	return 0;
 }
 
+#define MAX_GUARDED_DEVIRT_CLASSES 2
+
+static void
+emit_counter_inc (MonoCompile *cfg, gint32 *counter)
+{
+	int addr_reg = alloc_preg (cfg);
+	int val_reg = alloc_ireg (cfg);
+
+	MONO_EMIT_NEW_PCONST (cfg, addr_reg, counter);
+	MONO_EMIT_NEW_LOAD_MEMBASE_OP (cfg, OP_LOADI4_MEMBASE, val_reg, addr_reg, 0);
+	MONO_EMIT_NEW_BIALU_IMM (cfg, OP_IADD_IMM, val_reg, val_reg, 1);
+	MONO_EMIT_NEW_STORE_MEMBASE (cfg, OP_STOREI4_MEMBASE_REG, addr_reg, 0, val_reg);
+}
+
+/*
+ * emit_guarded_devirt_call:
+ *
+ *   Emit a virtual call to CMETHOD as a chain of checks of the receiver vtable
+ * against the classes recorded for CMETHOD in the devirt profile, each
+ * followed by an inlined (or direct) call to the implementation in that class,
+ * and a normal virtual call as the fallback:
+ *
+ *   if (this->vtable == vtable1)
+ *       res = <inlined Class1::Method>;
+ *   else if (this->vtable == vtable2)
+ *       res = <inlined Class2::Method>;
+ *   else
+ *       res = this->Method ();
+ *
+ * Returns FALSE if the call site can't be devirtualized, in which case no code is
+ * emitted. Otherwise, OUT_INS is set to the result of the call, or NULL if the method
+ * returns void, and OUT_COSTS to the cost of the inlined code.
+ */
+static gboolean
+emit_guarded_devirt_call (MonoCompile *cfg, MonoMethod *cmethod, MonoMethodSignature *fsig, MonoInst **sp, guchar *ip,
+						  MonoInst **out_ins, int *out_costs)
+{
+	MonoClass *classes [MAX_GUARDED_DEVIRT_CLASSES];
+	MonoMethod *impls [MAX_GUARDED_DEVIRT_CLASSES];
+	MonoVTable *vtables [MAX_GUARDED_DEVIRT_CLASSES];
+	MonoDevirtProfileEntry *entry;
+	MonoBasicBlock *end_bb, *next_bb, *hit_bb;
+	MonoInst *rvar = NULL, *ins, *store, **args;
+	int i, nclasses, n, vtable_reg, slot, costs = 0;
+	gboolean is_iface = (cmethod->klass->flags & TYPE_ATTRIBUTE_INTERFACE) != 0;
+	gboolean count = mono_jit_stats.enabled && !cfg->compile_aot;
+
+	if (MONO_TYPE_ISSTRUCT (fsig->ret))
+		return FALSE;
+	for (i = 0; i < fsig->param_count; ++i)
+		if (MONO_TYPE_ISSTRUCT (fsig->params [i]))
+			return FALSE;
+
+	nclasses = mono_devirt_profile_get_classes (cmethod, classes, MAX_GUARDED_DEVIRT_CLASSES, &entry);
+
+	/* Compute the implementations up front, so nothing is emitted if there are none */
+	slot = mono_method_get_vtable_slot (cmethod);
+	if (slot == -1)
+		return FALSE;
+	n = 0;
+	for (i = 0; i < nclasses; ++i) {
+		MonoClass *klass = classes [i];
+		MonoMethod *impl;
+		int offset = slot;
+
+		if (klass->exception_type || !mono_class_is_assignable_from (cmethod->klass, klass))
+			continue;
+		if (is_iface) {
+			offset = mono_class_interface_offset (klass, cmethod->klass);
+			if (offset == -1)
+				continue;
+			offset += slot;
+		}
+		impl = mono_class_get_vtable_entry (klass, offset);
+		if (!impl || (impl->flags & METHOD_ATTRIBUTE_ABSTRACT) || impl->is_inflated || impl->klass->generic_container ||
+			(impl->iflags & METHOD_IMPL_ATTRIBUTE_INTERNAL_CALL) || (impl->flags & METHOD_ATTRIBUTE_PINVOKE_IMPL) ||
+			mono_class_is_marshalbyref (impl->klass))
+			continue;
+		vtables [n] = mono_class_vtable (cfg->domain, klass);
+		if (!vtables [n])
+			continue;
+		impls [n] = impl;
+		n ++;
+	}
+	if (!n)
+		return FALSE;
+
+	if (cfg->verbose_level > 1) {
+		for (i = 0; i < n; ++i)
+			printf ("GUARDED DEVIRT %s -> %s\n", mono_method_full_name (cmethod, TRUE), mono_method_full_name (impls [i], TRUE));
+	}
+
+	if (!MONO_TYPE_IS_VOID (fsig->ret))
+		rvar = mono_compile_create_var (cfg, fsig->ret, OP_LOCAL);
+
+	/* inline_method () overwrites its sp argument with the return value */
+	args = mono_mempool_alloc (cfg->mempool, sizeof (MonoInst*) * (fsig->param_count + 1));
+
+	/* This also serves as the null check */
+	vtable_reg = alloc_preg (cfg);
+	MONO_EMIT_NEW_LOAD_MEMBASE_FAULT (cfg, vtable_reg, sp [0]->dreg, MONO_STRUCT_OFFSET (MonoObject, vtable));
+
+	NEW_BBLOCK (cfg, end_bb);
+
+	for (i = 0; i < n; ++i) {
+		MonoInst *vtable_ins;
+		int inline_costs;
+
+		NEW_BBLOCK (cfg, next_bb);
+		NEW_BBLOCK (cfg, hit_bb);
+
+		EMIT_NEW_VTABLECONST (cfg, vtable_ins, vtables [i]);
+		MONO_EMIT_NEW_BIALU (cfg, OP_COMPARE, -1, vtable_reg, vtable_ins->dreg);
+		MONO_EMIT_NEW_BRANCH_BLOCK (cfg, OP_PBNE_UN, next_bb);
+		MONO_START_BB (cfg, hit_bb);
+
+		if (count)
+			emit_counter_inc (cfg, mono_devirt_profile_entry_get_hits (entry));
+
+		memcpy (args, sp, sizeof (MonoInst*) * (fsig->param_count + 1));
+		inline_costs = 0;
+		if ((cfg->opt & MONO_OPT_INLINE) && mono_method_check_inlining (cfg, impls [i]))
+			inline_costs = inline_method (cfg, impls [i], NULL, args, ip, cfg->real_offset, FALSE, NULL);
+		if (inline_costs) {
+			costs += inline_costs;
+			ins = args [0];
+		} else {
+			/* The vtable load above already checked for null, so a direct call is enough */
+			ins = mono_emit_method_call_full (cfg, impls [i], fsig, FALSE, args, NULL, NULL, NULL);
+			if (rvar)
+				ins = mono_emit_widen_call_res (cfg, ins, fsig);
+		}
+		if (rvar)
+			EMIT_NEW_TEMPSTORE (cfg, store, rvar->inst_c0, ins);
+		MONO_EMIT_NEW_BRANCH_BLOCK (cfg, OP_BR, end_bb);
+
+		MONO_START_BB (cfg, next_bb);
+	}
+
+	/* Fallback */
+	if (count)
+		emit_counter_inc (cfg, mono_devirt_profile_entry_get_misses (entry));
+	ins = mono_emit_method_call_full (cfg, cmethod, fsig, FALSE, sp, sp [0], NULL, NULL);
+	if (rvar) {
+		ins = mono_emit_widen_call_res (cfg, ins, fsig);
+		EMIT_NEW_TEMPSTORE (cfg, store, rvar->inst_c0, ins);
+	}
+
+	MONO_START_BB (cfg, end_bb);
+
+	cfg->stat_guarded_devirt_calls ++;
+	*out_costs = costs;
+
+	if (rvar)
+		EMIT_NEW_TEMPLOAD (cfg, ins, rvar->inst_c0);
+	else
+		ins = NULL;
+	*out_ins = ins;
+	return TRUE;
+}
+
 /*
  * Some of these comments may well be out-of-date.
  * Design decisions: we do a single pass over the IL code (and we do bblock 
@@ -9301,6 +9462,25 @@ mono_method_to_ir (MonoCompile *cfg, MonoMethod *method, MonoBasicBlock *start_b
 				goto call_end;
 			}
 
+			/* Guarded devirtualization based on the receiver type profile */
+			if ((cfg->opt & MONO_OPT_INLINE) && mono_devirt_profile_enabled () && !cfg->inline_depth &&
+				virtual && (cmethod->flags & METHOD_ATTRIBUTE_VIRTUAL) && !MONO_METHOD_IS_FINAL (cmethod) &&
+				!context_used && !vtable_arg && !imt_arg && !cfg->gshared && !cfg->gsharedvt && !cfg->compile_llvm &&
+				!constrained_class && !delegate_invoke && !array_rank && !fsig->generic_param_count && fsig->hasthis &&
+				!cmethod->is_inflated && cmethod->wrapper_type == MONO_WRAPPER_NONE && !cmethod->klass->valuetype &&
+				!mono_class_is_marshalbyref (cmethod->klass) && method->wrapper_type == MONO_WRAPPER_NONE) {
+				int costs = 0;
+
+				if (emit_guarded_devirt_call (cfg, cmethod, fsig, sp, ip, &ins, &costs)) {
+					bblock = cfg->cbb;
+					if (costs)
+						cfg->real_offset += 5;
+					inline_costs += costs;
+					emit_widen = FALSE;
+					goto call_end;
+				}
+			}
+
 			/* Inlining */
 			if ((cfg->opt & MONO_OPT_INLINE) &&
 				(!virtual || !(cmethod->flags & METHOD_ATTRIBUTE_VIRTUAL) || MONO_METHOD_IS_FINAL (cmethod)) &&
@@ -65,6 +65,9 @@ static gboolean optimize_for_xen = TRUE;
 #define mono_mini_arch_unlock() mono_mutex_unlock (&mini_arch_mutex)
 static mono_mutex_t mini_arch_mutex;
 
+/* Whenever to use the non destructive VEX encoded (AVX) forms of SSE instructions */
+static gboolean use_avx;
+
 MonoBreakpointInfo
 mono_breakpoint_info [MONO_BREAKPOINT_ARRAY_SIZE];
 
@@ -1317,6 +1320,10 @@ mono_arch_init (void)
 	mono_aot_register_jit_icall ("mono_amd64_throw_exception", mono_amd64_throw_exception);
 	mono_aot_register_jit_icall ("mono_amd64_throw_corlib_exception", mono_amd64_throw_corlib_exception);
 	mono_aot_register_jit_icall ("mono_amd64_get_original_ip", mono_amd64_get_original_ip);
+
+#if !defined(__native_client_codegen__)
+	use_avx = (mono_arch_cpu_enumerate_simd_versions () & SIMD_VERSION_AVX) != 0;
+#endif
 }
 
 /*
@@ -1389,6 +1396,12 @@ mono_arch_cpu_enumerate_simd_versions (void)
 	if (mono_hwcap_x86_has_sse4a)
 		sse_opts |= SIMD_VERSION_SSE4a;
 
+	if (mono_hwcap_x86_has_avx)
+		sse_opts |= SIMD_VERSION_AVX;
+
+	if (mono_hwcap_x86_has_avx2)
+		sse_opts |= SIMD_VERSION_AVX2;
+
 	return sse_opts;
 }
 
@@ -3214,6 +3227,74 @@ mono_arch_peephole_pass_2 (MonoCompile *cfg, MonoBasicBlock *bb)
  *  Converts complex opcodes into simpler ones so that each IR instruction
  * corresponds to one machine instruction.
  */
+/*
+ * avx_opcode:
+ *
+ *   Return the VEX encoded three operand version of the two operand SSE opcode
+ * OPCODE, or -1 if there is none. Using these saves the register allocator from
+ * having to copy sreg1 into dreg.
+ */
+static int
+avx_opcode (int opcode)
+{
+	switch (opcode) {
+	case OP_FADD:
+		return OP_AMD64_VADDSD;
+	case OP_FSUB:
+		return OP_AMD64_VSUBSD;
+	case OP_FMUL:
+		return OP_AMD64_VMULSD;
+	case OP_FDIV:
+		return OP_AMD64_VDIVSD;
+	case OP_RADD:
+		return OP_AMD64_VADDSS;
+	case OP_RSUB:
+		return OP_AMD64_VSUBSS;
+	case OP_RMUL:
+		return OP_AMD64_VMULSS;
+	case OP_RDIV:
+		return OP_AMD64_VDIVSS;
+#ifdef MONO_ARCH_SIMD_INTRINSICS
+	case OP_ADDPS:
+		return OP_AMD64_VADDPS;
+	case OP_SUBPS:
+		return OP_AMD64_VSUBPS;
+	case OP_MULPS:
+		return OP_AMD64_VMULPS;
+	case OP_DIVPS:
+		return OP_AMD64_VDIVPS;
+	case OP_ANDPS:
+		return OP_AMD64_VANDPS;
+	case OP_ORPS:
+		return OP_AMD64_VORPS;
+	case OP_XORPS:
+		return OP_AMD64_VXORPS;
+	case OP_ADDPD:
+		return OP_AMD64_VADDPD;
+	case OP_SUBPD:
+		return OP_AMD64_VSUBPD;
+	case OP_MULPD:
+		return OP_AMD64_VMULPD;
+	case OP_DIVPD:
+		return OP_AMD64_VDIVPD;
+	case OP_PADDD:
+		return OP_AMD64_VPADDD;
+	case OP_PSUBD:
+		return OP_AMD64_VPSUBD;
+	case OP_PMULD:
+		return OP_AMD64_VPMULD;
+	case OP_PAND:
+		return OP_AMD64_VPAND;
+	case OP_POR:
+		return OP_AMD64_VPOR;
+	case OP_PXOR:
+		return OP_AMD64_VPXOR;
+#endif
+	default:
+		return -1;
+	}
+}
+
 void
 mono_arch_lowering_pass (MonoCompile *cfg, MonoBasicBlock *bb)
 {
@@ -3298,6 +3379,12 @@ mono_arch_lowering_pass (MonoCompile *cfg, MonoBasicBlock *bb)
 			break;
 #endif
 		default:
+			if (use_avx) {
+				int vex_opcode = avx_opcode (ins->opcode);
+
+				if (vex_opcode != -1)
+					ins->opcode = vex_opcode;
+			}
 			break;
 		}
 	}
@@ -5349,6 +5436,31 @@ mono_arch_output_basic_block (MonoCompile *cfg, MonoBasicBlock *bb)
 			break;
 		}
 
+		case OP_AMD64_VADDSD:
+			amd64_vex_addsd_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VSUBSD:
+			amd64_vex_subsd_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VMULSD:
+			amd64_vex_mulsd_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VDIVSD:
+			amd64_vex_divsd_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VADDSS:
+			amd64_vex_addss_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VSUBSS:
+			amd64_vex_subss_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VMULSS:
+			amd64_vex_mulss_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VDIVSS:
+			amd64_vex_divss_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+
 		case OP_IMIN:
 			g_assert (cfg->opt & MONO_OPT_CMOV);
 			g_assert (ins->dreg == ins->sreg1);
@@ -6256,6 +6368,58 @@ mono_arch_output_basic_block (MonoCompile *cfg, MonoBasicBlock *bb)
 		case OP_PMULD:
 			amd64_sse_pmulld_reg_reg (code, ins->sreg1, ins->sreg2);
 			break;
+
+		case OP_AMD64_VADDPS:
+			amd64_vex_addps_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VSUBPS:
+			amd64_vex_subps_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VMULPS:
+			amd64_vex_mulps_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VDIVPS:
+			amd64_vex_divps_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VANDPS:
+			amd64_vex_andps_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VORPS:
+			amd64_vex_orps_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VXORPS:
+			amd64_vex_xorps_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VADDPD:
+			amd64_vex_addpd_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VSUBPD:
+			amd64_vex_subpd_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VMULPD:
+			amd64_vex_mulpd_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VDIVPD:
+			amd64_vex_divpd_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VPADDD:
+			amd64_vex_paddd_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VPSUBD:
+			amd64_vex_psubd_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VPMULD:
+			amd64_vex_pmulld_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VPAND:
+			amd64_vex_pand_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VPOR:
+			amd64_vex_por_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
+		case OP_AMD64_VPXOR:
+			amd64_vex_pxor_reg_reg_reg (code, ins->dreg, ins->sreg1, ins->sreg2);
+			break;
 		case OP_PMULQ:
 			amd64_sse_pmuludq_reg_reg (code, ins->sreg1, ins->sreg2);
 			break;
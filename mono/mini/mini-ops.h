@@ -1155,6 +1155,33 @@ MINI_OP(OP_AMD64_MUL_REG_MEMBASE,        "amd64_mul_reg_membase", IREG, IREG, IR
 
 MINI_OP(OP_AMD64_LOADI8_MEMINDEX,        "amd64_loadi8_memindex", IREG, IREG, IREG)
 MINI_OP(OP_AMD64_SAVE_SP_TO_LMF,         "amd64_save_sp_to_lmf", NONE, NONE, NONE)
+
+/* Non destructive three operand forms using the VEX (AVX) encoding: dreg = sreg1 OP sreg2 */
+MINI_OP(OP_AMD64_VADDSD,                 "amd64_vaddsd", FREG, FREG, FREG)
+MINI_OP(OP_AMD64_VSUBSD,                 "amd64_vsubsd", FREG, FREG, FREG)
+MINI_OP(OP_AMD64_VMULSD,                 "amd64_vmulsd", FREG, FREG, FREG)
+MINI_OP(OP_AMD64_VDIVSD,                 "amd64_vdivsd", FREG, FREG, FREG)
+MINI_OP(OP_AMD64_VADDSS,                 "amd64_vaddss", FREG, FREG, FREG)
+MINI_OP(OP_AMD64_VSUBSS,                 "amd64_vsubss", FREG, FREG, FREG)
+MINI_OP(OP_AMD64_VMULSS,                 "amd64_vmulss", FREG, FREG, FREG)
+MINI_OP(OP_AMD64_VDIVSS,                 "amd64_vdivss", FREG, FREG, FREG)
+MINI_OP(OP_AMD64_VADDPS,                 "amd64_vaddps", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VSUBPS,                 "amd64_vsubps", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VMULPS,                 "amd64_vmulps", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VDIVPS,                 "amd64_vdivps", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VANDPS,                 "amd64_vandps", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VORPS,                  "amd64_vorps", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VXORPS,                 "amd64_vxorps", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VADDPD,                 "amd64_vaddpd", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VSUBPD,                 "amd64_vsubpd", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VMULPD,                 "amd64_vmulpd", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VDIVPD,                 "amd64_vdivpd", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VPADDD,                 "amd64_vpaddd", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VPSUBD,                 "amd64_vpsubd", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VPMULD,                 "amd64_vpmuld", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VPAND,                  "amd64_vpand", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VPOR,                   "amd64_vpor", XREG, XREG, XREG)
+MINI_OP(OP_AMD64_VPXOR,                  "amd64_vpxor", XREG, XREG, XREG)
 #endif
 
 #if  defined(__ppc__) || defined(__powerpc__) || defined(__ppc64__) || defined(TARGET_POWERPC)
@@ -2807,6 +2807,7 @@ register_jit_stats (void)
 	mono_counters_register ("Allocated seq points size", MONO_COUNTER_JIT | MONO_COUNTER_INT, &mono_jit_stats.allocated_seq_points_size);
 	mono_counters_register ("Inlineable methods", MONO_COUNTER_JIT | MONO_COUNTER_INT, &mono_jit_stats.inlineable_methods);
 	mono_counters_register ("Inlined methods", MONO_COUNTER_JIT | MONO_COUNTER_INT, &mono_jit_stats.inlined_methods);
+	mono_counters_register ("Guarded devirtualized calls", MONO_COUNTER_JIT | MONO_COUNTER_INT, &mono_jit_stats.guarded_devirt_calls);
 	mono_counters_register ("Regvars", MONO_COUNTER_JIT | MONO_COUNTER_INT, &mono_jit_stats.regvars);
 	mono_counters_register ("Locals stack size", MONO_COUNTER_JIT | MONO_COUNTER_INT, &mono_jit_stats.locals_stack_size);
 	mono_counters_register ("Method cache lookups", MONO_COUNTER_JIT | MONO_COUNTER_INT, &mono_jit_stats.methods_lookups);
@@ -3072,6 +3073,8 @@ mini_init (const char *filename, const char *runtime_version)
 
 	mono_trampolines_init ();
 
+	mono_devirt_profile_init ();
+
 	mono_native_tls_alloc (&mono_jit_tls_id, NULL);
 
 	if (default_opt & MONO_OPT_AOT)
@@ -3502,6 +3505,8 @@ mini_cleanup (MonoDomain *domain)
 	/* This accesses metadata so needs to be called before runtime shutdown */
 	print_jit_stats ();
 
+	mono_devirt_profile_cleanup ();
+
 	mono_profiler_shutdown ();
 
 #ifndef MONO_CROSS_COMPILE
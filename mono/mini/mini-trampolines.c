@@ -757,6 +757,9 @@ mono_vcall_trampoline (mgreg_t *regs, guint8 *code, int slot, guint8 *tramp)
 		/* Normal virtual call */
 		vtable_slot = &(vt->vtable [slot]);
 
+		if (mono_devirt_profile_enabled ())
+			mono_devirt_profile_record (vt, slot, NULL);
+
 		/* Avoid loading metadata or creating a generic vtable if possible */
 		addr = mono_aot_get_method_from_vt_slot (mono_domain_get (), vt, slot);
 		if (addr && !vt->klass->valuetype) {
@@ -786,6 +789,9 @@ mono_vcall_trampoline (mgreg_t *regs, guint8 *code, int slot, guint8 *tramp)
 		/* IMT call */
 		vtable_slot = &(((gpointer*)vt) [slot]);
 
+		if (mono_devirt_profile_enabled ())
+			mono_devirt_profile_record (vt, slot, mono_arch_find_imt_method (regs, code));
+
 		m = NULL;
 		need_rgctx_tramp = FALSE;
 	}
@@ -4266,6 +4266,7 @@ mono_jit_compile_method_inner (MonoMethod *method, MonoDomain *target_domain, in
 	mono_jit_stats.regvars += cfg->stat_n_regvars;
 	mono_jit_stats.inlineable_methods += cfg->stat_inlineable_methods;
 	mono_jit_stats.inlined_methods += cfg->stat_inlined_methods;
+	mono_jit_stats.guarded_devirt_calls += cfg->stat_guarded_devirt_calls;
 	mono_jit_stats.cas_demand_generation += cfg->stat_cas_demand_generation;
 	mono_jit_stats.code_reallocs += cfg->stat_code_reallocs;
 
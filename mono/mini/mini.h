@@ -1699,6 +1699,7 @@ typedef struct {
 	int stat_n_regvars;
 	int stat_inlineable_methods;
 	int stat_inlined_methods;
+	int stat_guarded_devirt_calls;
 	int stat_cas_demand_generation;
 	int stat_code_reallocs;
 } MonoCompile;
@@ -1729,6 +1730,7 @@ typedef struct {
 	gint32 allocated_seq_points_size;
 	gint32 inlineable_methods;
 	gint32 inlined_methods;
+	gint32 guarded_devirt_calls;
 	gint32 basic_blocks;
 	gint32 max_basic_blocks;
 	gint32 locals_stack_size;
@@ -2715,6 +2717,17 @@ MONO_API void      mono_debugger_run_finally             (MonoContext *start_ctx
 
 MONO_API gboolean mono_breakpoint_clean_code (guint8 *method_start, guint8 *code, int offset, guint8 *buf, int size);
 
+/* Guarded devirtualization */
+typedef struct _MonoDevirtProfileEntry MonoDevirtProfileEntry;
+
+void      mono_devirt_profile_init          (void);
+void      mono_devirt_profile_cleanup       (void);
+gboolean  mono_devirt_profile_enabled       (void);
+void      mono_devirt_profile_record        (MonoVTable *vt, int slot, MonoMethod *imt_method);
+int       mono_devirt_profile_get_classes   (MonoMethod *method, MonoClass **classes, int max, MonoDevirtProfileEntry **out_entry);
+gint32   *mono_devirt_profile_entry_get_hits   (MonoDevirtProfileEntry *entry);
+gint32   *mono_devirt_profile_entry_get_misses (MonoDevirtProfileEntry *entry);
+
 /* Tracing */
 MonoTraceSpec *mono_trace_parse_options         (const char *options);
 void           mono_trace_set_assembly          (MonoAssembly *assembly);
@@ -2886,15 +2899,18 @@ enum {
 	SIMD_VERSION_SSE41	= 1 << 4,
 	SIMD_VERSION_SSE42	= 1 << 5,
 	SIMD_VERSION_SSE4a	= 1 << 6,
+	SIMD_VERSION_AVX	= 1 << 7,
+	SIMD_VERSION_AVX2	= 1 << 8,
 	SIMD_VERSION_ALL	= SIMD_VERSION_SSE1 | SIMD_VERSION_SSE2 |
 			  SIMD_VERSION_SSE3 | SIMD_VERSION_SSSE3 |
 			  SIMD_VERSION_SSE41 | SIMD_VERSION_SSE42 |
-			  SIMD_VERSION_SSE4a,
+			  SIMD_VERSION_SSE4a | SIMD_VERSION_AVX |
+			  SIMD_VERSION_AVX2,
 
 	/* this value marks the end of the bit indexes used in 
 	 * this emum.
 	 */
-	SIMD_VERSION_INDEX_END = 6 
+	SIMD_VERSION_INDEX_END = 8 
 };
 
 enum {
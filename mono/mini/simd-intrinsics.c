@@ -1475,6 +1475,10 @@ simd_version_name (guint32 version)
 		return "sse42";
 	case SIMD_VERSION_SSE4a:
 		return "sse4a";
+	case SIMD_VERSION_AVX:
+		return "avx";
+	case SIMD_VERSION_AVX2:
+		return "avx2";
 	}
 	return "n/a";
 }
@@ -38,9 +38,11 @@ gboolean mono_hwcap_x86_has_ssse3 = FALSE;
 gboolean mono_hwcap_x86_has_sse41 = FALSE;
 gboolean mono_hwcap_x86_has_sse42 = FALSE;
 gboolean mono_hwcap_x86_has_sse4a = FALSE;
+gboolean mono_hwcap_x86_has_avx = FALSE;
+gboolean mono_hwcap_x86_has_avx2 = FALSE;
 
 static gboolean
-cpuid (int id, int *p_eax, int *p_ebx, int *p_ecx, int *p_edx)
+cpuid_count (int id, int count, int *p_eax, int *p_ebx, int *p_ecx, int *p_edx)
 {
 #if defined(_MSC_VER)
 	int info [4];
@@ -90,7 +92,7 @@ cpuid (int id, int *p_eax, int *p_ebx, int *p_ecx, int *p_edx)
 	/* Now issue the actual cpuid instruction. We can use
 	   MSVC's __cpuid on both 32-bit and 64-bit. */
 #if defined(_MSC_VER)
-	__cpuid (info, id);
+	__cpuidex (info, id, count);
 	*p_eax = info [0];
 	*p_ebx = info [1];
 	*p_ecx = info [2];
@@ -103,19 +105,49 @@ cpuid (int id, int *p_eax, int *p_ebx, int *p_ecx, int *p_edx)
 		"cpuid\n\t"
 		"xchgl\t%%ebx, %k1\n\t"
 		: "=a" (*p_eax), "=&r" (*p_ebx), "=c" (*p_ecx), "=d" (*p_edx)
-		: "0" (id)
+		: "0" (id), "2" (count)
 	);
 #else
 	__asm__ __volatile__ (
 		"cpuid\n\t"
 		: "=a" (*p_eax), "=b" (*p_ebx), "=c" (*p_ecx), "=d" (*p_edx)
-		: "a" (id)
+		: "a" (id), "c" (count)
 	);
 #endif
 
 	return TRUE;
 }
 
+static gboolean
+cpuid (int id, int *p_eax, int *p_ebx, int *p_ecx, int *p_edx)
+{
+	return cpuid_count (id, 0, p_eax, p_ebx, p_ecx, p_edx);
+}
+
+/*
+ * Read the low 32 bits of XCR0, which tell us which register
+ * states the OS saves on context switches. Only call this if
+ * CPUID reports OSXSAVE.
+ */
+static guint32
+xgetbv_xcr0 (void)
+{
+#if defined(_MSC_VER)
+	return (guint32) _xgetbv (0);
+#else
+	guint32 eax, edx;
+
+	/* xgetbv, encoded by hand for old assemblers. */
+	__asm__ __volatile__ (
+		".byte 0x0f, 0x01, 0xd0\n\t"
+		: "=a" (eax), "=d" (edx)
+		: "c" (0)
+	);
+
+	return eax;
+#endif
+}
+
 void
 mono_hwcap_arch_init (void)
 {
@@ -146,6 +178,20 @@ mono_hwcap_arch_init (void)
 
 		if (ecx & (1 << 20))
 			mono_hwcap_x86_has_sse42 = TRUE;
+
+		/*
+		 * AVX needs both the CPU bit and the OS saving the
+		 * XMM and YMM register state (XCR0 bits 1 and 2).
+		 */
+		if ((ecx & (1 << 28)) && (ecx & (1 << 27)) && (xgetbv_xcr0 () & 0x6) == 0x6)
+			mono_hwcap_x86_has_avx = TRUE;
+	}
+
+	if (mono_hwcap_x86_has_avx && cpuid (0, &eax, &ebx, &ecx, &edx) && eax >= 7) {
+		if (cpuid_count (7, 0, &eax, &ebx, &ecx, &edx)) {
+			if (ebx & (1 << 5))
+				mono_hwcap_x86_has_avx2 = TRUE;
+		}
 	}
 
 	if (cpuid (0x80000000, &eax, &ebx, &ecx, &edx)) {
@@ -175,4 +221,6 @@ mono_hwcap_print (FILE *f)
 	g_fprintf (f, "mono_hwcap_x86_has_sse41 = %i\n", mono_hwcap_x86_has_sse41);
 	g_fprintf (f, "mono_hwcap_x86_has_sse42 = %i\n", mono_hwcap_x86_has_sse42);
 	g_fprintf (f, "mono_hwcap_x86_has_sse4a = %i\n", mono_hwcap_x86_has_sse4a);
+	g_fprintf (f, "mono_hwcap_x86_has_avx = %i\n", mono_hwcap_x86_has_avx);
+	g_fprintf (f, "mono_hwcap_x86_has_avx2 = %i\n", mono_hwcap_x86_has_avx2);
 }